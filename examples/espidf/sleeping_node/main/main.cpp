@@ -38,11 +38,17 @@ void app_main();
 void app_main(void) {
   ESP_LOGI(LOG_TAG, "This device IEEE802.15.4 MAC: 0x%llx", _ieee802154_node.deviceMacAddress());
 
+  // Initialize the radio in the background while sampling sensors.
+  _ieee802154_node.prepare();
+
   ApplicationMessage message = {
       .temperature = 25.2,
   };
   _ieee802154_node.sendMessage((uint8_t *)&message, sizeof(ApplicationMessage));
 
+  // Turn off the radio kept initialized since prepare().
+  _ieee802154_node.release();
+
   esp_sleep_enable_timer_wakeup(SLEEP_TIME_US);
   esp_sleep_config_gpio_isolate();
   esp_sleep_cpu_retention_init();
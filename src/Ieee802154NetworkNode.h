@@ -1,10 +1,15 @@
 #pragma once
 
+#include "impl/FrameCapture.h"
 #include "impl/NvsStorage.h"
+#include "impl/ReceiveRing.h"
 #include <GCMEncryption.h>
 #include <Ieee802154.h>
 #include <OtaHelper.h>
+#include <atomic>
 #include <cstdint>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
 #include <functional>
 #include <mutex>
 #include <optional>
@@ -56,8 +61,25 @@ public:
   };
 
   Ieee802154NetworkNode(Configuration configuration);
+  ~Ieee802154NetworkNode();
 
 public:
+  /**
+   * Optional. Start initialization of NVS, the radio and loading of the stored host and channel in the background, so
+   * a following sendMessage() only has to transmit. Call right after wakeup, before for example sampling sensors. The
+   * firmware is still only marked as good (OTA rollback cancelled) by sendMessage().
+   * After calling this, the radio is kept initialized between sendMessage() calls, until release() is called. Without
+   * prepare(), every sendMessage() initializes and turns off the radio.
+   * The initialization runs in a separate task. release() and the destructor wait for it to complete.
+   */
+  void prepare();
+
+  /**
+   * Turn off the radio kept initialized since prepare(), after waiting for an ongoing prepare() to complete. Call
+   * before going into deep sleep.
+   */
+  void release();
+
   /**
    * Send a message to the host.
    * If no host can be found or there is channel mismatch, will go into discovery mode and try to find the host.
@@ -107,6 +129,16 @@ public:
     _on_firmware_update_complete = on_firmware_update_complete;
   }
 
+  /**
+   * Set a frame capture to record all transmitted and received frames into, both encrypted and decrypted. Use
+   * FrameCapture::exportPcap() and FrameCapture::exportDecryptedPcap() to get the traffic for offline analysis.
+   * Set to nullptr to stop capturing. The frame capture must outlive this instance or be unset.
+   */
+  void setFrameCapture(FrameCapture *frame_capture) {
+    std::scoped_lock lock(_send_mutex);
+    _frame_capture = frame_capture;
+  }
+
   /**
    * Forget any previous stored channel and host MAC address.
    */
@@ -127,11 +159,18 @@ private:
   };
 
   void initializeNvs();
+  void initialize();
+  void finish();
+  void forgetLocked();
+  void waitForPrepare();
   void teardown();
   bool sendApplicationMessage(uint8_t *message, uint8_t message_size);
   bool performDiscovery();
   bool requestData();
   bool performFirmwareUpdateViaWifi(FirmwareUpdate &firmware_update);
+  void captureFrame(FrameCapture::FrameType type, bool incoming, uint64_t peer_address, uint8_t sequence_number,
+                    const uint8_t *encrypted, size_t encrypted_size, const void *decrypted, size_t decrypted_size,
+                    std::optional<int64_t> timestamp_us = std::nullopt);
 
   struct DiscoveredHost {
     uint64_t mac_address;
@@ -139,6 +178,10 @@ private:
     int8_t rssi;
   };
 
+  void handleDiscoveryResponses(std::vector<DiscoveredHost> &discovered_hosts);
+  void updateEncryptionOverhead(const std::vector<uint8_t> &encrypted, size_t message_size);
+  std::vector<uint8_t> decryptFrame(const ReceiveRing::Frame &frame, size_t minimum_message_size);
+
 private:
   static constexpr char NVS_KEY_HOST[] = "host";
   static constexpr char NVS_KEY_CHANNEL[] = "channel";
@@ -149,12 +192,22 @@ private:
   NvsStorage _nvs_storage;
   Configuration _configuration;
   GCMEncryption _gcm_encryption;
+  ReceiveRing _receive_ring;
 
 private:
   uint64_t _host_address;
+  uint8_t _channel = 0;
+  size_t _encryption_overhead = 0;
   std::mutex _send_mutex;
   bool _nvs_initialized = false;
+  bool _rollback_cancelled = false;
+  bool _radio_initialized = false;
+  bool _link_state_loaded = false;
+  std::atomic<bool> _keep_initialized = false;
+  bool _prepare_pending = false; // Only accessed by the task calling prepare() and release().
+  EventGroupHandle_t _prepare_done = nullptr;
   OnFirmwareUpdateComplete _on_firmware_update_complete;
+  FrameCapture *_frame_capture = nullptr;
 
   // Pending states
 private:
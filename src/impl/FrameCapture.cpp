@@ -0,0 +1,164 @@
+#include "FrameCapture.h"
+#include <algorithm>
+#include <cstring>
+
+// https://www.tcpdump.org/linktypes.html
+#define LINKTYPE_IEEE802_15_4_NOFCS 230
+#define PCAP_MAGIC_MICROSECONDS 0xa1b2c3d4
+
+// 802.15.4 frame control field.
+#define FRAME_TYPE_DATA 0x0001
+#define FRAME_TYPE_MAC_COMMAND 0x0003
+#define FRAME_ACK_REQUEST 0x0020
+#define FRAME_PAN_ID_COMPRESSION 0x0040
+#define FRAME_DESTINATION_SHORT 0x0800
+#define FRAME_DESTINATION_EXTENDED 0x0C00
+#define FRAME_SOURCE_EXTENDED 0xC000
+#define MAC_COMMAND_DATA_REQUEST 0x04
+
+// Frame control + sequence number + PAN ID + two extended addresses.
+#define MAX_HEADER_SIZE (2 + 1 + 2 + 8 + 8)
+
+namespace {
+size_t putLittleEndian(uint8_t *buffer, uint64_t value, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    buffer[i] = (uint8_t)(value >> (8 * i));
+  }
+  return size;
+}
+} // namespace
+
+FrameCapture::FrameCapture(size_t capacity) : _entries(std::max(capacity, (size_t)1)) {}
+
+void FrameCapture::record(const Frame &frame) {
+  std::scoped_lock lock(_mutex);
+
+  auto &entry = _entries[_recorded % _entries.size()];
+  entry.type = frame.type;
+  entry.timestamp_us = frame.timestamp_us;
+  entry.pan_id = frame.pan_id;
+  entry.sequence_number = frame.sequence_number;
+  entry.source_address = frame.source_address;
+  entry.destination_address = frame.destination_address;
+  entry.encrypted_size = std::min(frame.encrypted_size, MAX_PAYLOAD_SIZE);
+  entry.decrypted_size = std::min(frame.decrypted_size, MAX_PAYLOAD_SIZE);
+  if (frame.encrypted != nullptr) {
+    memcpy(entry.encrypted, frame.encrypted, entry.encrypted_size);
+  } else {
+    entry.encrypted_size = 0;
+  }
+  if (frame.decrypted != nullptr) {
+    memcpy(entry.decrypted, frame.decrypted, entry.decrypted_size);
+  } else {
+    entry.decrypted_size = 0;
+  }
+
+  ++_recorded;
+  if (_count < _entries.size()) {
+    ++_count;
+  } else {
+    ++_overwritten;
+  }
+}
+
+void FrameCapture::exportPcap(OnExportChunk on_chunk) { exportPcap(on_chunk, false); }
+
+void FrameCapture::exportDecryptedPcap(OnExportChunk on_chunk) { exportPcap(on_chunk, true); }
+
+void FrameCapture::exportPcap(OnExportChunk on_chunk, bool decrypted) {
+  // on_chunk() can be slow (UART, file), so never call it with the lock held, as that would block record().
+  // Copy one entry at a time instead of the whole ring, to not double the memory usage.
+  size_t first, last;
+  {
+    std::scoped_lock lock(_mutex);
+    first = _recorded - _count;
+    last = _recorded;
+  }
+
+  uint8_t global_header[24];
+  size_t offset = 0;
+  offset += putLittleEndian(global_header + offset, PCAP_MAGIC_MICROSECONDS, 4);
+  offset += putLittleEndian(global_header + offset, 2, 2);     // Major version.
+  offset += putLittleEndian(global_header + offset, 4, 2);     // Minor version.
+  offset += putLittleEndian(global_header + offset, 0, 4);     // Timezone offset.
+  offset += putLittleEndian(global_header + offset, 0, 4);     // Timestamp accuracy.
+  offset += putLittleEndian(global_header + offset, 65535, 4); // Snapshot length.
+  offset += putLittleEndian(global_header + offset, LINKTYPE_IEEE802_15_4_NOFCS, 4);
+  on_chunk(global_header, offset);
+
+  Entry entry;
+  uint8_t record[16 + MAX_HEADER_SIZE + MAX_PAYLOAD_SIZE];
+  for (size_t i = first; i < last; ++i) {
+    {
+      std::scoped_lock lock(_mutex);
+      if (i >= _recorded) {
+        break; // Cleared during export.
+      }
+      if (i < _recorded - _count) {
+        continue; // Overwritten during export.
+      }
+      entry = _entries[i % _entries.size()];
+    }
+
+    size_t frame_size = writeHeader(entry, record + 16);
+    if (entry.type == FrameType::DataRequest) {
+      record[16 + frame_size++] = MAC_COMMAND_DATA_REQUEST;
+    } else {
+      auto payload = decrypted ? entry.decrypted : entry.encrypted;
+      auto payload_size = decrypted ? entry.decrypted_size : entry.encrypted_size;
+      memcpy(record + 16 + frame_size, payload, payload_size);
+      frame_size += payload_size;
+    }
+
+    offset = 0;
+    offset += putLittleEndian(record + offset, entry.timestamp_us / 1000000, 4);
+    offset += putLittleEndian(record + offset, entry.timestamp_us % 1000000, 4);
+    offset += putLittleEndian(record + offset, frame_size, 4); // Captured length.
+    offset += putLittleEndian(record + offset, frame_size, 4); // Original length.
+    on_chunk(record, offset + frame_size);
+  }
+}
+
+size_t FrameCapture::writeHeader(const Entry &entry, uint8_t *buffer) {
+  uint16_t frame_control = FRAME_PAN_ID_COMPRESSION | FRAME_SOURCE_EXTENDED;
+  switch (entry.type) {
+  case FrameType::Data:
+    frame_control |= FRAME_TYPE_DATA | FRAME_ACK_REQUEST | FRAME_DESTINATION_EXTENDED;
+    break;
+  case FrameType::Broadcast:
+    frame_control |= FRAME_TYPE_DATA | FRAME_DESTINATION_SHORT;
+    break;
+  case FrameType::DataRequest:
+    frame_control |= FRAME_TYPE_MAC_COMMAND | FRAME_ACK_REQUEST | FRAME_DESTINATION_EXTENDED;
+    break;
+  }
+
+  size_t offset = 0;
+  offset += putLittleEndian(buffer + offset, frame_control, 2);
+  buffer[offset++] = entry.sequence_number;
+  offset += putLittleEndian(buffer + offset, entry.pan_id, 2);
+  if (entry.type == FrameType::Broadcast) {
+    offset += putLittleEndian(buffer + offset, BROADCAST_ADDRESS, 2);
+  } else {
+    offset += putLittleEndian(buffer + offset, entry.destination_address, 8);
+  }
+  offset += putLittleEndian(buffer + offset, entry.source_address, 8);
+  return offset;
+}
+
+size_t FrameCapture::size() {
+  std::scoped_lock lock(_mutex);
+  return _count;
+}
+
+uint32_t FrameCapture::overwritten() {
+  std::scoped_lock lock(_mutex);
+  return _overwritten;
+}
+
+void FrameCapture::clear() {
+  std::scoped_lock lock(_mutex);
+  _recorded = 0;
+  _count = 0;
+  _overwritten = 0;
+}
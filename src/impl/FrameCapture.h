@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * Records radio frames into a fixed size RAM ring buffer, for export as pcap (LINKTYPE_IEEE802_15_4_NOFCS) so the
+ * traffic of a node can be analyzed offline in for example Wireshark. Both the encrypted (on air) payload and the
+ * decrypted payload is stored, and can be exported as two separate pcap files with identical frame headers and
+ * timestamps.
+ * The 802.15.4 MAC header is synthesized from the addresses and sequence number, as the radio driver only exposes the
+ * payload.
+ */
+class FrameCapture {
+public:
+  // Largest payload that fit in a 802.15.4 frame (PSDU).
+  static constexpr size_t MAX_PAYLOAD_SIZE = 127;
+  static constexpr uint64_t BROADCAST_ADDRESS = 0xFFFF;
+
+  enum class FrameType : uint8_t {
+    Data,        // Unicast data frame, from or to the node.
+    Broadcast,   // Broadcast data frame from the node.
+    DataRequest, // MAC command data request from the node.
+  };
+
+  struct Frame {
+    FrameType type;
+    int64_t timestamp_us; // Microseconds since boot, as returned by esp_timer_get_time().
+    uint16_t pan_id;
+    uint8_t sequence_number;
+    uint64_t source_address;
+    uint64_t destination_address; // BROADCAST_ADDRESS for broadcast frames.
+    const uint8_t *encrypted = nullptr;
+    size_t encrypted_size = 0;
+    const uint8_t *decrypted = nullptr;
+    size_t decrypted_size = 0;
+  };
+
+  /**
+   * Called for each chunk of the exported pcap file. The chunks should be written in order as is.
+   */
+  typedef std::function<void(const uint8_t *data, size_t size)> OnExportChunk;
+
+  /**
+   * @param capacity number of frames to keep. When full, the oldest frame is overwritten. All memory is allocated
+   * upfront.
+   */
+  FrameCapture(size_t capacity = 64);
+
+public:
+  /**
+   * Record a frame. Payloads larger than MAX_PAYLOAD_SIZE are truncated.
+   */
+  void record(const Frame &frame);
+
+  /**
+   * Export all recorded frames, oldest first, as pcap with the encrypted (on air) payload.
+   * Recording continues while exporting; frames overwritten during the export are skipped.
+   */
+  void exportPcap(OnExportChunk on_chunk);
+
+  /**
+   * Export all recorded frames, oldest first, as pcap with the decrypted payload. Frame headers and timestamps are the
+   * same as in exportPcap(), so the two files can be correlated frame by frame.
+   */
+  void exportDecryptedPcap(OnExportChunk on_chunk);
+
+  /**
+   * Number of frames currently in the ring buffer.
+   */
+  size_t size();
+
+  /**
+   * Number of frames overwritten since last clear() because the ring buffer was full.
+   */
+  uint32_t overwritten();
+
+  void clear();
+
+private:
+  struct Entry {
+    FrameType type;
+    int64_t timestamp_us;
+    uint16_t pan_id;
+    uint8_t sequence_number;
+    uint64_t source_address;
+    uint64_t destination_address;
+    uint8_t encrypted_size;
+    uint8_t decrypted_size;
+    uint8_t encrypted[MAX_PAYLOAD_SIZE];
+    uint8_t decrypted[MAX_PAYLOAD_SIZE];
+  };
+
+  void exportPcap(OnExportChunk on_chunk, bool decrypted);
+  size_t writeHeader(const Entry &entry, uint8_t *buffer);
+
+private:
+  std::mutex _mutex;
+  std::vector<Entry> _entries;
+  size_t _recorded = 0; // Total number of frames recorded since last clear(). Next slot is _recorded % capacity.
+  size_t _count = 0;
+  uint32_t _overwritten = 0;
+};
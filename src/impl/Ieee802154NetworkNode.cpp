@@ -2,8 +2,10 @@
 #include <Ieee802154NetworkShared.h>
 #include <WiFiHelper.h>
 #include <algorithm>
+#include <cinttypes>
 #include <cstring>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/event_groups.h>
 #include <freertos/task.h>
@@ -19,6 +21,7 @@ RTC_NOINIT_ATTR uint8_t _Ieee802154NetworkNode_next_sequence_number;
 RTC_NOINIT_ATTR uint32_t _Ieee802154NetworkNode_next_sequence_number_is_set;
 
 #define REQUESTED_DATA_MESSAGE_ANY BIT0
+#define PREPARE_DONE BIT0
 
 Ieee802154NetworkNode::Ieee802154NetworkNode(Configuration configuration)
     : _ota_helper({
@@ -40,6 +43,18 @@ Ieee802154NetworkNode::Ieee802154NetworkNode(Configuration configuration)
   _Ieee802154NetworkNode_next_sequence_number_is_set = SEQUENCE_NUMBER_IS_SET;
 }
 
+Ieee802154NetworkNode::~Ieee802154NetworkNode() {
+  // The prepare task holds a pointer to this instance.
+  waitForPrepare();
+  {
+    std::scoped_lock lock(_send_mutex);
+    teardown();
+  }
+  if (_prepare_done != nullptr) {
+    vEventGroupDelete(_prepare_done);
+  }
+}
+
 bool Ieee802154NetworkNode::sendMessage(std::vector<uint8_t> message) {
   return sendMessage(message.data(), message.size());
 }
@@ -47,34 +62,21 @@ bool Ieee802154NetworkNode::sendMessage(std::vector<uint8_t> message) {
 bool Ieee802154NetworkNode::sendMessage(uint8_t *message, uint8_t message_size) {
   std::scoped_lock lock(_send_mutex);
 
-  if (!_nvs_initialized) {
-    initializeNvs();
-    _ota_helper.cancelRollback();
-    _nvs_initialized = true;
-  }
-
-  bool initialize_nvs = false;
-  _ieee802154.initialize(initialize_nvs);
+  // No-op for the parts already done by prepare() or a previous sendMessage().
+  initialize();
 
-  // Read channel and host address from NVS.
-  uint8_t channel = 0;
-  bool read_ok = _nvs_storage.readFromNVS(NVS_KEY_CHANNEL, channel);
-  if (read_ok) {
-    _ieee802154.setChannel(channel);
-    read_ok = _nvs_storage.readFromNVS(NVS_KEY_HOST, _host_address);
-  }
-  if (read_ok) {
-    ESP_LOGI(Ieee802154NetworkNodeLog::TAG, "Read channel %d and host 0x%llx from NVS", channel, _host_address);
-  } else {
-    ESP_LOGW(Ieee802154NetworkNodeLog::TAG, "Failed to read channel and host from NVS");
+  // Only mark the firmware as good once the application got this far, not already in prepare().
+  if (!_rollback_cancelled) {
+    _ota_helper.cancelRollback();
+    _rollback_cancelled = true;
   }
 
   // If we failed to load from NVS, go directly to disovery.
-  if (!read_ok) {
+  if (!_link_state_loaded) {
     auto r = performDiscovery();
     if (!r) {
       ESP_LOGW(Ieee802154NetworkNodeLog::TAG, "Device discovery failed");
-      teardown();
+      finish();
       return r;
     }
   }
@@ -89,7 +91,7 @@ bool Ieee802154NetworkNode::sendMessage(uint8_t *message, uint8_t message_size)
     if (!r) {
       ESP_LOGW(Ieee802154NetworkNodeLog::TAG, "Data request failed");
     }
-    teardown();
+    finish();
     return r;
   } else {
     // Not good. Wait and try again.
@@ -106,7 +108,7 @@ bool Ieee802154NetworkNode::sendMessage(uint8_t *message, uint8_t message_size)
     if (!r) {
       ESP_LOGW(Ieee802154NetworkNodeLog::TAG, "Data request failed");
     }
-    teardown();
+    finish();
     return r;
   } else {
     ESP_LOGW(Ieee802154NetworkNodeLog::TAG, "Second attempt of sending message failed");
@@ -116,7 +118,7 @@ bool Ieee802154NetworkNode::sendMessage(uint8_t *message, uint8_t message_size)
     r = performDiscovery();
     if (!r) {
       ESP_LOGW(Ieee802154NetworkNodeLog::TAG, "Device discovery failed");
-      teardown();
+      finish();
       return r;
     } else {
       // Discovery OK, try sending message.
@@ -126,7 +128,7 @@ bool Ieee802154NetworkNode::sendMessage(uint8_t *message, uint8_t message_size)
   }
 
   ESP_LOGI(Ieee802154NetworkNodeLog::TAG, "End of sendMessage: %d", r);
-  teardown();
+  finish();
   return r;
 }
 
@@ -140,7 +142,10 @@ bool Ieee802154NetworkNode::sendApplicationMessage(uint8_t *message, uint8_t mes
   memcpy(wire_message->payload, message, message_size);
 
   auto encrypted = _gcm_encryption.encrypt(wire_message, wire_message_size);
+  updateEncryptionOverhead(encrypted, wire_message_size);
 
+  captureFrame(FrameCapture::FrameType::Data, false, _host_address, _ieee802154.nextSequenceNumber(),
+               encrypted.data(), encrypted.size(), wire_message, wire_message_size);
   return _ieee802154.transmit(_host_address, encrypted.data(), encrypted.size());
 }
 
@@ -148,47 +153,44 @@ bool Ieee802154NetworkNode::performDiscovery() {
   ESP_LOGI(Ieee802154NetworkNodeLog::TAG, "In device discovery");
 
   Ieee802154NetworkShared::DiscoveryRequestV1 discovery_request;
+  auto encrypted = _gcm_encryption.encrypt(&discovery_request, sizeof(Ieee802154NetworkShared::DiscoveryRequestV1));
+  if (encrypted.size() <= sizeof(Ieee802154NetworkShared::DiscoveryRequestV1)) {
+    ESP_LOGE(Ieee802154NetworkNodeLog::TAG, " -- Failed to encrypt discovery request");
+    return false;
+  }
+  updateEncryptionOverhead(encrypted, sizeof(Ieee802154NetworkShared::DiscoveryRequestV1));
   std::vector<DiscoveredHost> discovered_hosts;
   EventGroupHandle_t event_group = xEventGroupCreate();
 
+  // Only copy the frame in the radio callback, process it on this task.
+  _receive_ring.clear();
   _ieee802154.receive([&](Ieee802154::Message message) {
-    auto decrypted = _gcm_encryption.decrypt(message.payload);
-    uint8_t message_id = decrypted.data()[0];
-    if (message_id == Ieee802154NetworkShared::MESSAGE_ID_DISCOVERY_RESPONSE_V1) {
-      Ieee802154NetworkShared::DiscoveryResponseV1 *response =
-          reinterpret_cast<Ieee802154NetworkShared::DiscoveryResponseV1 *>(decrypted.data());
-
-      DiscoveredHost host = {
-          .mac_address = message.source_address,
-          .channel = response->channel,
-          .rssi = message.rssi,
-      };
-      discovered_hosts.push_back(host);
-      xEventGroupSetBits(event_group, REQUESTED_DATA_MESSAGE_ANY);
-      ESP_LOGI(Ieee802154NetworkNodeLog::TAG, " -- Got discovery response from 0x%llx on channel %d with RSSI %d",
-               host.mac_address, host.channel, host.rssi);
-    } else {
-      ESP_LOGW(Ieee802154NetworkNodeLog::TAG, " -- Got unknown message %d while waiting for device discovery response",
-               message_id);
-    }
+    _receive_ring.push(message);
+    xEventGroupSetBits(event_group, REQUESTED_DATA_MESSAGE_ANY);
   });
 
-  auto encrypted = _gcm_encryption.encrypt(&discovery_request, sizeof(Ieee802154NetworkShared::DiscoveryRequestV1));
-
   // Try each channel multiple times to gather all possible hosts.
   for (uint8_t channel = 26; channel >= 11; --channel) {
     _ieee802154.setChannel(channel);
     for (uint8_t attempt = 1; attempt <= 4; ++attempt) {
       ESP_LOGI(Ieee802154NetworkNodeLog::TAG, " -- Broadcasting discovery on channel %d, attempt %d...", channel,
                attempt);
+      captureFrame(FrameCapture::FrameType::Broadcast, false, FrameCapture::BROADCAST_ADDRESS,
+                   _ieee802154.nextSequenceNumber(), encrypted.data(), encrypted.size(), &discovery_request,
+                   sizeof(Ieee802154NetworkShared::DiscoveryRequestV1));
       _ieee802154.broadcast(encrypted.data(), encrypted.size());
 
       // Wait a short time to collect responses. This clears the event bits after reading.
       xEventGroupWaitBits(event_group, REQUESTED_DATA_MESSAGE_ANY, pdTRUE, pdFALSE, (30 / portTICK_PERIOD_MS));
+      handleDiscoveryResponses(discovered_hosts);
     }
   }
 
   _ieee802154.receive({}); // Stop receiving.
+  handleDiscoveryResponses(discovered_hosts);
+  if (_receive_ring.dropped() > 0) {
+    ESP_LOGW(Ieee802154NetworkNodeLog::TAG, " -- Dropped %" PRIu32 " received frames", _receive_ring.dropped());
+  }
 
   if (discovered_hosts.empty()) {
     ESP_LOGW(Ieee802154NetworkNodeLog::TAG, " -- Never received any device discovery response");
@@ -210,10 +212,12 @@ bool Ieee802154NetworkNode::performDiscovery() {
   auto best_host_it = std::max_element(best_per_host.begin(), best_per_host.end(),
                                        [](const auto &a, const auto &b) { return a.second.rssi < b.second.rssi; });
 
-  _ieee802154.setChannel(best_host_it->second.channel);
-  _nvs_storage.writeToNVS(NVS_KEY_CHANNEL, best_host_it->second.channel);
+  _channel = best_host_it->second.channel;
+  _ieee802154.setChannel(_channel);
+  _nvs_storage.writeToNVS(NVS_KEY_CHANNEL, _channel);
   _host_address = best_host_it->second.mac_address;
-  _nvs_storage.writeToNVS(NVS_KEY_HOST, best_host_it->second.mac_address);
+  _nvs_storage.writeToNVS(NVS_KEY_HOST, _host_address);
+  _link_state_loaded = true;
 
   ESP_LOGI(Ieee802154NetworkNodeLog::TAG, " -- Best host found: 0x%llx on channel %d with RSSI %d",
            best_host_it->second.mac_address, best_host_it->second.channel, best_host_it->second.rssi);
@@ -221,9 +225,40 @@ bool Ieee802154NetworkNode::performDiscovery() {
   vEventGroupDelete(event_group);
   return true;
 }
+
+void Ieee802154NetworkNode::handleDiscoveryResponses(std::vector<DiscoveredHost> &discovered_hosts) {
+  while (auto frame = _receive_ring.peek()) {
+    auto decrypted = decryptFrame(*frame, sizeof(Ieee802154NetworkShared::DiscoveryResponseV1));
+    if (decrypted.empty()) {
+      _receive_ring.pop();
+      continue;
+    }
+    uint8_t message_id = decrypted.data()[0];
+    if (message_id == Ieee802154NetworkShared::MESSAGE_ID_DISCOVERY_RESPONSE_V1) {
+      Ieee802154NetworkShared::DiscoveryResponseV1 *response =
+          reinterpret_cast<Ieee802154NetworkShared::DiscoveryResponseV1 *>(decrypted.data());
+
+      DiscoveredHost host = {
+          .mac_address = frame->source_address,
+          .channel = response->channel,
+          .rssi = frame->rssi,
+      };
+      discovered_hosts.push_back(host);
+      ESP_LOGI(Ieee802154NetworkNodeLog::TAG, " -- Got discovery response from 0x%llx on channel %d with RSSI %d",
+               host.mac_address, host.channel, host.rssi);
+    } else {
+      ESP_LOGW(Ieee802154NetworkNodeLog::TAG, " -- Got unknown message %d while waiting for device discovery response",
+               message_id);
+    }
+    _receive_ring.pop();
+  }
+}
+
 bool Ieee802154NetworkNode::requestData() {
   ESP_LOGI(Ieee802154NetworkNodeLog::TAG, "Requesting data");
 
+  captureFrame(FrameCapture::FrameType::DataRequest, false, _host_address, _ieee802154.nextSequenceNumber(),
+               nullptr, 0, nullptr, 0);
   auto result = _ieee802154.dataRequest(_host_address);
   EventGroupHandle_t event_group = xEventGroupCreate();
 
@@ -245,15 +280,23 @@ bool Ieee802154NetworkNode::requestData() {
   uint32_t firmware_checksum_identifier = 0;
   uint32_t firmware_credentials_identifier = 0;
   std::optional<FirmwareUpdate> _pending_firmware;
-  _ieee802154.receive([&](Ieee802154::Message message) {
-    auto decrypted = _gcm_encryption.decrypt(message.payload);
+  bool perform_discovery = false;
+  // Returns true if the frame was a message from the host that was handled.
+  auto handle_frame = [&](const ReceiveRing::Frame &frame) -> bool {
+    if (frame.source_address != _host_address) {
+      ESP_LOGW(Ieee802154NetworkNodeLog::TAG, " -- Ignoring message from 0x%llx, not from host", frame.source_address);
+      return false;
+    }
+    auto decrypted = decryptFrame(frame, 1);
+    if (decrypted.empty()) {
+      return false;
+    }
     uint8_t message_id = decrypted.data()[0];
     switch (message_id) {
     case Ieee802154NetworkShared::MESSAGE_ID_FORGET_HOST_RESPONSE_V1: {
       ESP_LOGI(Ieee802154NetworkNodeLog::TAG, " -- Got forgetHostResponseV1");
-      forget();
-      performDiscovery(); // Perform discovery directly.
-      xEventGroupSetBits(event_group, REQUESTED_DATA_MESSAGE_ANY);
+      forgetLocked();
+      perform_discovery = true; // Perform discovery once all data has been received.
       break;
     }
 
@@ -263,7 +306,6 @@ bool Ieee802154NetworkNode::requestData() {
           reinterpret_cast<Ieee802154NetworkShared::PendingTimestampResponseV1 *>(decrypted.data());
       auto timestamp = response->timestamp;
       _pending_timestamp = timestamp;
-      xEventGroupSetBits(event_group, REQUESTED_DATA_MESSAGE_ANY);
       break;
     }
 
@@ -271,7 +313,6 @@ bool Ieee802154NetworkNode::requestData() {
       ESP_LOGI(Ieee802154NetworkNodeLog::TAG, " -- Got PendingPayloadResponseV1");
       _pending_payload = std::vector<uint8_t>(
           decrypted.begin() + sizeof(Ieee802154NetworkShared::PendingPayloadResponseV1), decrypted.end());
-      xEventGroupSetBits(event_group, REQUESTED_DATA_MESSAGE_ANY);
       break;
     }
 
@@ -286,7 +327,6 @@ bool Ieee802154NetworkNode::requestData() {
       strncpy(_pending_firmware->wifi_ssid, response->wifi_ssid, sizeof(_pending_firmware->wifi_ssid));
       strncpy(_pending_firmware->wifi_password, response->wifi_password, sizeof(_pending_firmware->wifi_password));
       firmware_credentials_identifier = response->identifier;
-      xEventGroupSetBits(event_group, REQUESTED_DATA_MESSAGE_ANY);
       break;
     }
 
@@ -300,7 +340,6 @@ bool Ieee802154NetworkNode::requestData() {
       }
       strncpy(_pending_firmware->md5, response->md5, sizeof(_pending_firmware->md5));
       firmware_checksum_identifier = response->identifier;
-      xEventGroupSetBits(event_group, REQUESTED_DATA_MESSAGE_ANY);
       break;
     }
 
@@ -314,28 +353,55 @@ bool Ieee802154NetworkNode::requestData() {
       }
       strncpy(_pending_firmware->url, response->url, sizeof(_pending_firmware->url));
       firmware_url_identifier = response->identifier;
-      xEventGroupSetBits(event_group, REQUESTED_DATA_MESSAGE_ANY);
       break;
     }
 
     default:
       ESP_LOGW(Ieee802154NetworkNodeLog::TAG, " -- Got unhandled message %d", message_id);
-      break;
+      return false;
     }
+    return true;
+  };
+
+  // Only copy the frame in the radio callback, process it on this task.
+  _receive_ring.clear();
+  _ieee802154.receive([&](Ieee802154::Message message) {
+    _receive_ring.push(message);
+    xEventGroupSetBits(event_group, REQUESTED_DATA_MESSAGE_ANY);
   });
 
-  // Wait until no more messages has been received within a period.
+  // Wait until no more messages from the host has been handled within a period. Other frames, like from other nodes
+  // or that fail to decrypt, only wake up this task and does not extend the wait.
+  TickType_t wait_until = xTaskGetTickCount() + (1000 / portTICK_PERIOD_MS);
   while (1) {
-    auto bits =
-        xEventGroupWaitBits(event_group, REQUESTED_DATA_MESSAGE_ANY, pdTRUE, pdFALSE, (1000 / portTICK_PERIOD_MS));
-    auto got_any_message = ((bits & REQUESTED_DATA_MESSAGE_ANY) != 0);
-    if (!got_any_message) {
+    TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(wait_until - now) <= 0) {
       break;
     }
+    xEventGroupWaitBits(event_group, REQUESTED_DATA_MESSAGE_ANY, pdTRUE, pdFALSE, wait_until - now);
+    bool handled_any_message = false;
+    while (auto frame = _receive_ring.peek()) {
+      handled_any_message |= handle_frame(*frame);
+      _receive_ring.pop();
+    }
+    if (handled_any_message) {
+      wait_until = xTaskGetTickCount() + (1000 / portTICK_PERIOD_MS);
+    }
   }
   ESP_LOGI(Ieee802154NetworkNodeLog::TAG, " -- Data wait complete");
 
   _ieee802154.receive({}); // Stop receiving.
+  while (auto frame = _receive_ring.peek()) {
+    handle_frame(*frame);
+    _receive_ring.pop();
+  }
+  if (_receive_ring.dropped() > 0) {
+    ESP_LOGW(Ieee802154NetworkNodeLog::TAG, " -- Dropped %" PRIu32 " received frames", _receive_ring.dropped());
+  }
+
+  if (perform_discovery) {
+    performDiscovery();
+  }
 
   // If we now have a complete firmware update, lets go and update the firmware.
   if (_pending_firmware) {
@@ -420,15 +486,162 @@ std::optional<std::vector<uint8_t>> Ieee802154NetworkNode::pendingPayload() {
   return pending;
 }
 
+void Ieee802154NetworkNode::updateEncryptionOverhead(const std::vector<uint8_t> &encrypted, size_t message_size) {
+  // GCM does not pad, so the size difference is the fixed encryption overhead per message. Unknown (0) until the first
+  // successful encryption, in which case received frames are only checked against the minimum message size.
+  if (encrypted.size() > message_size) {
+    _encryption_overhead = encrypted.size() - message_size;
+  }
+}
+
+std::vector<uint8_t> Ieee802154NetworkNode::decryptFrame(const ReceiveRing::Frame &frame, size_t minimum_message_size) {
+  // Reject frames that cannot hold a valid message before copying and decrypting them. This is only a size check,
+  // the integrity (GCM tag) is verified as part of decrypt().
+  if (frame.payload_size < _encryption_overhead + minimum_message_size) {
+    ESP_LOGW(Ieee802154NetworkNodeLog::TAG, " -- Ignoring message of %d bytes from 0x%llx, too short",
+             frame.payload_size, frame.source_address);
+    captureFrame(FrameCapture::FrameType::Data, true, frame.source_address, 0, frame.payload, frame.payload_size,
+                 nullptr, 0, frame.timestamp_us);
+    return {};
+  }
+
+  std::vector<uint8_t> encrypted(frame.payload, frame.payload + frame.payload_size);
+  auto decrypted = _gcm_encryption.decrypt(encrypted);
+  captureFrame(FrameCapture::FrameType::Data, true, frame.source_address, 0, frame.payload, frame.payload_size,
+               decrypted.data(), decrypted.size(), frame.timestamp_us);
+
+  if (decrypted.empty()) {
+    ESP_LOGW(Ieee802154NetworkNodeLog::TAG, " -- Failed to decrypt message from 0x%llx", frame.source_address);
+  }
+  return decrypted;
+}
+
+void Ieee802154NetworkNode::captureFrame(FrameCapture::FrameType type, bool incoming, uint64_t peer_address,
+                                         uint8_t sequence_number, const uint8_t *encrypted, size_t encrypted_size,
+                                         const void *decrypted, size_t decrypted_size,
+                                         std::optional<int64_t> timestamp_us) {
+  if (_frame_capture == nullptr) {
+    return;
+  }
+
+  // Sequence number of received frames is not exposed by the radio driver.
+  auto device_address = deviceMacAddress();
+  _frame_capture->record({
+      .type = type,
+      .timestamp_us = timestamp_us.value_or(esp_timer_get_time()),
+      .pan_id = _configuration.pan_id,
+      .sequence_number = sequence_number,
+      .source_address = incoming ? peer_address : device_address,
+      .destination_address = incoming ? device_address : peer_address,
+      .encrypted = encrypted,
+      .encrypted_size = encrypted_size,
+      .decrypted = reinterpret_cast<const uint8_t *>(decrypted),
+      .decrypted_size = decrypted_size,
+  });
+}
+
 uint64_t Ieee802154NetworkNode::deviceMacAddress() { return _ieee802154.deviceMacAddress(); }
 
+void Ieee802154NetworkNode::prepare() {
+  _keep_initialized = true;
+  if (_prepare_pending) {
+    return; // Already started, or done and not yet released.
+  }
+  if (_prepare_done == nullptr) {
+    _prepare_done = xEventGroupCreate();
+  }
+  xEventGroupClearBits(_prepare_done, PREPARE_DONE);
+  _prepare_pending = true;
+  auto created = xTaskCreate(
+      [](void *parameters) {
+        auto node = static_cast<Ieee802154NetworkNode *>(parameters);
+        {
+          std::scoped_lock lock(node->_send_mutex);
+          node->initialize();
+        }
+        // Must not access the node after this, as it might be destroyed once the bit is set.
+        xEventGroupSetBits(node->_prepare_done, PREPARE_DONE);
+        vTaskDelete(NULL);
+      },
+      "ieee802154_prepare", 4096, this, uxTaskPriorityGet(NULL), NULL);
+  if (created != pdPASS) {
+    // sendMessage() will initialize instead.
+    ESP_LOGW(Ieee802154NetworkNodeLog::TAG, "Failed to create prepare task");
+    _prepare_pending = false;
+  }
+}
+
+void Ieee802154NetworkNode::waitForPrepare() {
+  if (_prepare_pending) {
+    xEventGroupWaitBits(_prepare_done, PREPARE_DONE, pdTRUE, pdFALSE, portMAX_DELAY);
+    _prepare_pending = false;
+  }
+}
+
+void Ieee802154NetworkNode::release() {
+  waitForPrepare();
+  std::scoped_lock lock(_send_mutex);
+  _keep_initialized = false;
+  teardown();
+}
+
+void Ieee802154NetworkNode::initialize() {
+  if (!_nvs_initialized) {
+    initializeNvs();
+    _nvs_initialized = true;
+  }
+
+  if (!_radio_initialized) {
+    bool initialize_nvs = false;
+    _ieee802154.initialize(initialize_nvs);
+    _radio_initialized = true;
+  }
+
+  if (!_link_state_loaded) {
+    // Read channel and host address from NVS.
+    bool read_ok = _nvs_storage.readFromNVS(NVS_KEY_CHANNEL, _channel);
+    if (read_ok) {
+      read_ok = _nvs_storage.readFromNVS(NVS_KEY_HOST, _host_address);
+    }
+    if (read_ok) {
+      ESP_LOGI(Ieee802154NetworkNodeLog::TAG, "Read channel %d and host 0x%llx from NVS", _channel, _host_address);
+    } else {
+      ESP_LOGW(Ieee802154NetworkNodeLog::TAG, "Failed to read channel and host from NVS");
+    }
+    _link_state_loaded = read_ok;
+  }
+
+  // Always apply, as a failed discovery leaves a kept initialized radio on the last swept channel.
+  if (_link_state_loaded) {
+    _ieee802154.setChannel(_channel);
+  }
+}
+
+void Ieee802154NetworkNode::finish() {
+  if (_keep_initialized) {
+    // Store in RTC memory
+    _Ieee802154NetworkNode_next_sequence_number = _ieee802154.nextSequenceNumber();
+  } else {
+    teardown();
+  }
+}
+
 void Ieee802154NetworkNode::teardown() {
   // Store in RTC memory
   _Ieee802154NetworkNode_next_sequence_number = _ieee802154.nextSequenceNumber();
-  return _ieee802154.teardown();
+  if (_radio_initialized) {
+    _ieee802154.teardown();
+    _radio_initialized = false;
+  }
 }
 
 void Ieee802154NetworkNode::forget() {
+  std::scoped_lock lock(_send_mutex);
+  forgetLocked();
+}
+
+void Ieee802154NetworkNode::forgetLocked() {
+  _link_state_loaded = false;
   _nvs_storage.eraseKey(NVS_KEY_HOST);
   _nvs_storage.eraseKey(NVS_KEY_CHANNEL);
 }
@@ -0,0 +1,41 @@
+#include "ReceiveRing.h"
+#include <algorithm>
+#include <cstring>
+#include <esp_timer.h>
+
+bool ReceiveRing::push(const Ieee802154::Message &message) {
+  auto tail = _tail.load(std::memory_order_relaxed);
+  auto next = (tail + 1) % CAPACITY;
+  if (next == _head.load(std::memory_order_acquire)) {
+    _dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  auto &frame = _frames[tail];
+  frame.timestamp_us = esp_timer_get_time();
+  frame.source_address = message.source_address;
+  frame.rssi = message.rssi;
+  frame.payload_size = std::min(message.payload.size(), MAX_PAYLOAD_SIZE);
+  memcpy(frame.payload, message.payload.data(), frame.payload_size);
+
+  _tail.store(next, std::memory_order_release);
+  return true;
+}
+
+const ReceiveRing::Frame *ReceiveRing::peek() {
+  auto head = _head.load(std::memory_order_relaxed);
+  if (head == _tail.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return &_frames[head];
+}
+
+void ReceiveRing::pop() {
+  auto head = _head.load(std::memory_order_relaxed);
+  _head.store((head + 1) % CAPACITY, std::memory_order_release);
+}
+
+void ReceiveRing::clear() {
+  _head.store(_tail.load(std::memory_order_acquire), std::memory_order_release);
+  _dropped.store(0, std::memory_order_relaxed);
+}
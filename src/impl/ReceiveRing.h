@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Ieee802154.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Preallocated single producer/single consumer ring buffer for received frames.
+ * The radio receive callback (producer) only copies the frame into a free slot, and the sending task (consumer) does
+ * the decryption and processing, so the radio driver is never stalled by the processing of a frame.
+ */
+class ReceiveRing {
+public:
+  // Number of slots. One slot is always kept free to distinguish full from empty, so 15 frames fit.
+  // The largest burst the host sends back to back is 6 frames after a data request (forget host, timestamp, payload
+  // and three firmware update messages). During discovery, each host responds once per broadcast and the ring is
+  // drained after each 30 ms wait, so up to 15 hosts in range can respond without drops. See test/ReceiveRingTest.cpp.
+  static constexpr size_t CAPACITY = 16;
+  // Largest payload that fit in a 802.15.4 frame (PSDU).
+  static constexpr size_t MAX_PAYLOAD_SIZE = 127;
+
+  struct Frame {
+    int64_t timestamp_us; // Microseconds since boot when received.
+    uint64_t source_address;
+    int8_t rssi;
+    uint8_t payload_size;
+    uint8_t payload[MAX_PAYLOAD_SIZE];
+  };
+
+public:
+  /**
+   * Producer side. Copy the message into the next free slot.
+   * @return false if the ring is full and the message was dropped.
+   */
+  bool push(const Ieee802154::Message &message);
+
+  /**
+   * Consumer side. Get the oldest frame, or nullptr if empty. The frame is valid until pop() is called.
+   */
+  const Frame *peek();
+
+  /**
+   * Consumer side. Release the frame returned by peek().
+   */
+  void pop();
+
+  /**
+   * Discard all frames and reset the dropped counter. Only call when there is no producer.
+   */
+  void clear();
+
+  /**
+   * Number of frames dropped since last clear() because the ring was full.
+   */
+  uint32_t dropped() { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+  Frame _frames[CAPACITY];
+  std::atomic<size_t> _head = 0; // Next slot to read. Written by consumer.
+  std::atomic<size_t> _tail = 0; // Next slot to write. Written by producer.
+  std::atomic<uint32_t> _dropped = 0;
+};
@@ -0,0 +1,209 @@
+#include "FrameCapture.h"
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+#define EXPECT(condition)                                                                                              \
+  if (!(condition)) {                                                                                                  \
+    printf("%s:%d: expected %s\n", __FILE__, __LINE__, #condition);                                                    \
+    ++failures;                                                                                                        \
+  }
+
+static constexpr uint16_t PAN_ID = 0x1234;
+static constexpr uint64_t NODE_ADDRESS = 0x0102030405060708ULL;
+static constexpr uint64_t HOST_ADDRESS = 0x1112131415161718ULL;
+
+static const std::vector<uint8_t> GLOBAL_HEADER = {
+    0xd4, 0xc3, 0xb2, 0xa1, // Magic, microsecond timestamps.
+    0x02, 0x00, 0x04, 0x00, // Version 2.4.
+    0x00, 0x00, 0x00, 0x00, // Timezone offset.
+    0x00, 0x00, 0x00, 0x00, // Timestamp accuracy.
+    0xff, 0xff, 0x00, 0x00, // Snapshot length.
+    0xe6, 0x00, 0x00, 0x00, // LINKTYPE_IEEE802_15_4_NOFCS (230).
+};
+
+struct Export {
+  std::vector<std::vector<uint8_t>> chunks;
+  std::vector<uint8_t> bytes;
+};
+
+static Export exportFrom(FrameCapture &capture, bool decrypted) {
+  Export result;
+  auto on_chunk = [&](const uint8_t *data, size_t size) {
+    result.chunks.emplace_back(data, data + size);
+    result.bytes.insert(result.bytes.end(), data, data + size);
+  };
+  if (decrypted) {
+    capture.exportDecryptedPcap(on_chunk);
+  } else {
+    capture.exportPcap(on_chunk);
+  }
+  return result;
+}
+
+static std::vector<uint8_t> recordHeader(uint32_t seconds, uint32_t microseconds, uint32_t length) {
+  std::vector<uint8_t> header;
+  for (auto value : {seconds, microseconds, length, length}) {
+    for (int i = 0; i < 4; ++i) {
+      header.push_back((uint8_t)(value >> (8 * i)));
+    }
+  }
+  return header;
+}
+
+static std::vector<uint8_t> concat(std::initializer_list<std::vector<uint8_t>> parts) {
+  std::vector<uint8_t> result;
+  for (auto &part : parts) {
+    result.insert(result.end(), part.begin(), part.end());
+  }
+  return result;
+}
+
+static void testFrameTypes() {
+  FrameCapture capture(8);
+  uint8_t encrypted[] = {0xaa, 0xbb};
+  uint8_t decrypted[] = {0x01};
+
+  capture.record({
+      .type = FrameCapture::FrameType::Broadcast,
+      .timestamp_us = 1500000,
+      .pan_id = PAN_ID,
+      .sequence_number = 0x11,
+      .source_address = NODE_ADDRESS,
+      .destination_address = FrameCapture::BROADCAST_ADDRESS,
+      .encrypted = encrypted,
+      .encrypted_size = sizeof(encrypted),
+      .decrypted = decrypted,
+      .decrypted_size = sizeof(decrypted),
+  });
+  capture.record({
+      .type = FrameCapture::FrameType::Data,
+      .timestamp_us = 2000001,
+      .pan_id = PAN_ID,
+      .sequence_number = 0x22,
+      .source_address = HOST_ADDRESS,
+      .destination_address = NODE_ADDRESS,
+      .encrypted = encrypted,
+      .encrypted_size = sizeof(encrypted),
+      .decrypted = decrypted,
+      .decrypted_size = sizeof(decrypted),
+  });
+  capture.record({
+      .type = FrameCapture::FrameType::DataRequest,
+      .timestamp_us = 3000000,
+      .pan_id = PAN_ID,
+      .sequence_number = 0x33,
+      .source_address = NODE_ADDRESS,
+      .destination_address = HOST_ADDRESS,
+  });
+  EXPECT(capture.size() == 3);
+  EXPECT(capture.overwritten() == 0);
+
+  std::vector<uint8_t> node = {0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01};
+  std::vector<uint8_t> host = {0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11};
+  // Data frame, PAN ID compression, short destination, extended source.
+  auto broadcast_header = concat({{0x41, 0xc8, 0x11, 0x34, 0x12, 0xff, 0xff}, node});
+  // Data frame, ack request, PAN ID compression, extended destination and source.
+  auto data_header = concat({{0x61, 0xcc, 0x22, 0x34, 0x12}, node, host});
+  // MAC command frame, ack request, PAN ID compression, extended destination and source, data request command.
+  auto data_request = concat({{0x63, 0xcc, 0x33, 0x34, 0x12}, host, node, {0x04}});
+
+  auto expected = concat({
+      GLOBAL_HEADER,
+      recordHeader(1, 500000, 17),
+      broadcast_header,
+      {0xaa, 0xbb},
+      recordHeader(2, 1, 23),
+      data_header,
+      {0xaa, 0xbb},
+      recordHeader(3, 0, 22),
+      data_request,
+  });
+  auto exported = exportFrom(capture, false);
+  EXPECT(exported.chunks.size() == 4);
+  EXPECT(exported.bytes == expected);
+
+  // Sidecar has the same headers and timestamps, with the decrypted payload.
+  auto expected_decrypted = concat({
+      GLOBAL_HEADER,
+      recordHeader(1, 500000, 16),
+      broadcast_header,
+      {0x01},
+      recordHeader(2, 1, 22),
+      data_header,
+      {0x01},
+      recordHeader(3, 0, 22),
+      data_request,
+  });
+  EXPECT(exportFrom(capture, true).bytes == expected_decrypted);
+}
+
+static void testOverwrite() {
+  FrameCapture capture(2);
+  for (uint8_t i = 0; i < 3; ++i) {
+    capture.record({
+        .type = FrameCapture::FrameType::Broadcast,
+        .timestamp_us = i,
+        .pan_id = PAN_ID,
+        .sequence_number = i,
+        .source_address = NODE_ADDRESS,
+        .destination_address = FrameCapture::BROADCAST_ADDRESS,
+    });
+  }
+  EXPECT(capture.size() == 2);
+  EXPECT(capture.overwritten() == 1);
+
+  // Oldest frame is gone, the two newest are exported oldest first.
+  auto exported = exportFrom(capture, false);
+  EXPECT(exported.chunks.size() == 3);
+  if (exported.chunks.size() == 3) {
+    EXPECT(exported.chunks[1][16 + 2] == 1); // Sequence number.
+    EXPECT(exported.chunks[2][16 + 2] == 2);
+  }
+
+  capture.clear();
+  EXPECT(capture.size() == 0);
+  EXPECT(capture.overwritten() == 0);
+  EXPECT(exportFrom(capture, false).bytes == GLOBAL_HEADER);
+}
+
+// Frames overwritten while the export is in progress are skipped. Recording from within on_chunk() also verifies that
+// the lock is not held while calling it.
+static void testOverwriteDuringExport() {
+  FrameCapture capture(2);
+  auto record = [&](uint8_t sequence_number) {
+    capture.record({
+        .type = FrameCapture::FrameType::Broadcast,
+        .timestamp_us = sequence_number,
+        .pan_id = PAN_ID,
+        .sequence_number = sequence_number,
+        .source_address = NODE_ADDRESS,
+        .destination_address = FrameCapture::BROADCAST_ADDRESS,
+    });
+  };
+  record(0);
+  record(1);
+
+  std::vector<uint8_t> sequence_numbers;
+  size_t chunks = 0;
+  capture.exportPcap([&](const uint8_t *data, size_t size) {
+    if (chunks++ == 0) {
+      record(2); // Overwrites frame 0, before it has been exported.
+    } else if (size > 16 + 2) {
+      sequence_numbers.push_back(data[16 + 2]);
+    }
+  });
+  EXPECT(sequence_numbers == std::vector<uint8_t>({1}));
+  EXPECT(capture.overwritten() == 1);
+}
+
+int main() {
+  testFrameTypes();
+  testOverwrite();
+  testOverwriteDuringExport();
+  if (failures == 0) {
+    printf("All tests passed\n");
+  }
+  return failures == 0 ? 0 : 1;
+}
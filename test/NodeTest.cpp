@@ -0,0 +1,274 @@
+#include "Ieee802154NetworkNode.h"
+#include "SimulatedMedium.h"
+#include <Ieee802154NetworkShared.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+static int failures = 0;
+
+#define EXPECT(condition)                                                                                              \
+  if (!(condition)) {                                                                                                  \
+    printf("%s:%d: expected %s\n", __FILE__, __LINE__, #condition);                                                    \
+    ++failures;                                                                                                        \
+  }
+
+static constexpr uint64_t HOST_ADDRESS = 0x1112131415161718ULL;
+static constexpr uint64_t OTHER_HOST_ADDRESS = 0x2122232425262728ULL;
+static constexpr uint64_t OTHER_NODE_ADDRESS = 0x3132333435363738ULL;
+static constexpr uint8_t HOST_CHANNEL = 15;
+
+static Ieee802154NetworkNode::Configuration configuration = {
+    .gcm_encryption_key = "0123456789abcdef",
+    .gcm_encryption_secret = "01234567",
+    .firmware_version = 1,
+};
+
+static GCMEncryption host_encryption("0123456789abcdef", "01234567", false);
+
+static Ieee802154::Message fromHost(uint64_t source_address, std::vector<uint8_t> message, int8_t rssi = -40) {
+  return {
+      .source_address = source_address,
+      .rssi = rssi,
+      .payload = host_encryption.encrypt(message.data(), message.size()),
+  };
+}
+
+static std::vector<uint8_t> timestampResponse(uint64_t timestamp) {
+  Ieee802154NetworkShared::PendingTimestampResponseV1 response;
+  response.timestamp = timestamp;
+  auto bytes = reinterpret_cast<const uint8_t *>(&response);
+  return std::vector<uint8_t>(bytes, bytes + sizeof(response));
+}
+
+static std::vector<uint8_t> payloadResponse(uint8_t value, size_t size) {
+  std::vector<uint8_t> response(1 + size, value);
+  response[0] = Ieee802154NetworkShared::MESSAGE_ID_PENDING_PAYLOAD_RESPONSE_V1;
+  return response;
+}
+
+static void storeLinkState(uint8_t channel, uint64_t host_address) {
+  NvsStorage nvs_storage("Ieee802154");
+  nvs_storage.writeToNVS("channel", channel);
+  nvs_storage.writeToNVS("host", host_address);
+}
+
+// Host that acknowledges messages on its channel and answers the data request with the given frames, sent back to
+// back right after the acknowledgement.
+static SimulatedMedium::Host hostWithPendingData(std::vector<Ieee802154::Message> frames,
+                                                 std::chrono::microseconds gap = {}) {
+  return {
+      .on_transmit = [](uint8_t channel, uint64_t destination_address,
+                        std::vector<uint8_t>) { return channel == HOST_CHANNEL && destination_address == HOST_ADDRESS; },
+      .on_broadcast = {},
+      .on_data_request =
+          [frames, gap](uint8_t channel, uint64_t destination_address) {
+            if (channel != HOST_CHANNEL || destination_address != HOST_ADDRESS) {
+              return Ieee802154::DataRequestResult::Failure;
+            }
+            SimulatedMedium::instance().send(frames, {}, gap);
+            return Ieee802154::DataRequestResult::DataAvailable;
+          },
+  };
+}
+
+static SimulatedMedium::Host hostWithoutPendingData() {
+  return {
+      .on_transmit = [](uint8_t channel, uint64_t destination_address,
+                        std::vector<uint8_t>) { return channel == HOST_CHANNEL && destination_address == HOST_ADDRESS; },
+      .on_broadcast = {},
+      .on_data_request = [](uint8_t, uint64_t) { return Ieee802154::DataRequestResult::NoDataAvailable; },
+  };
+}
+
+static void reset(SimulatedMedium::Host host) {
+  SimulatedMedium::instance().reset(host);
+  nvs_stub_storage.clear();
+  GCMEncryption::decrypt_delay = std::chrono::microseconds(0);
+  GCMEncryption::decrypt_calls = 0;
+}
+
+// The largest burst the host sends after a data request (forget host, timestamp, payload and the three firmware
+// update messages), at radio speed, while the sending task is slower than the radio at processing each frame.
+static void testHostBurstWithSlowConsumer() {
+  std::vector<Ieee802154::Message> burst = {fromHost(HOST_ADDRESS, timestampResponse(1700000000))};
+  for (uint8_t i = 1; i <= 5; ++i) {
+    burst.push_back(fromHost(HOST_ADDRESS, payloadResponse(i, 60)));
+  }
+  reset(hostWithPendingData(burst));
+  storeLinkState(HOST_CHANNEL, HOST_ADDRESS);
+  GCMEncryption::decrypt_delay = std::chrono::milliseconds(10);
+  EXPECT(SimulatedMedium::airTime(burst.back().payload.size()) < GCMEncryption::decrypt_delay);
+
+  FrameCapture capture;
+  Ieee802154NetworkNode node(configuration);
+  node.setFrameCapture(&capture);
+  EXPECT(node.sendMessage({0x01, 0x02}));
+  SimulatedMedium::instance().waitForDeliveries();
+
+  EXPECT(SimulatedMedium::instance().delivered() == burst.size());
+  EXPECT(SimulatedMedium::instance().lost() == 0);
+  // Message, data request and every frame in the burst.
+  EXPECT(capture.size() == 2 + burst.size());
+  EXPECT(node.pendingTimestamp() == 1700000000);
+  auto payload = node.pendingPayload();
+  EXPECT(payload && *payload == std::vector<uint8_t>(60, 5));
+}
+
+// Negative control: a burst larger than the receive ring is not fully processed when the consumer is slow, showing
+// that the test above exercises the ring.
+static void testBurstLargerThanRing() {
+  std::vector<Ieee802154::Message> burst;
+  for (uint8_t i = 1; i <= 3 * ReceiveRing::CAPACITY; ++i) {
+    burst.push_back(fromHost(HOST_ADDRESS, payloadResponse(i, 60)));
+  }
+  reset(hostWithPendingData(burst));
+  storeLinkState(HOST_CHANNEL, HOST_ADDRESS);
+  GCMEncryption::decrypt_delay = std::chrono::milliseconds(10);
+
+  FrameCapture capture;
+  Ieee802154NetworkNode node(configuration);
+  node.setFrameCapture(&capture);
+  EXPECT(node.sendMessage({0x01}));
+  SimulatedMedium::instance().waitForDeliveries();
+
+  EXPECT(SimulatedMedium::instance().delivered() == burst.size());
+  EXPECT(capture.size() < 2 + burst.size());
+}
+
+// Frames from other nodes keep arriving during the data wait, but do not extend it.
+static void testForeignFramesDoNotExtendDataWait() {
+  std::vector<Ieee802154::Message> frames;
+  for (int i = 0; i < 10; ++i) {
+    frames.push_back(fromHost(OTHER_NODE_ADDRESS, payloadResponse(i, 10)));
+  }
+  reset(hostWithPendingData(frames, std::chrono::milliseconds(300)));
+  storeLinkState(HOST_CHANNEL, HOST_ADDRESS);
+
+  Ieee802154NetworkNode node(configuration);
+  auto start = std::chrono::steady_clock::now();
+  EXPECT(node.sendMessage({0x01}));
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT(elapsed >= std::chrono::milliseconds(1000));
+  EXPECT(elapsed < std::chrono::milliseconds(1500));
+  EXPECT(!node.pendingPayload());
+}
+
+// Frames from other nodes and frames too short to hold a message are rejected without decryption.
+static void testInvalidFramesAreNotDecrypted() {
+  std::vector<Ieee802154::Message> frames = {
+      fromHost(OTHER_NODE_ADDRESS, payloadResponse(1, 10)),
+      {.source_address = HOST_ADDRESS, .rssi = -40, .payload = std::vector<uint8_t>(GCMEncryption::IV_SIZE, 0)},
+      fromHost(HOST_ADDRESS, payloadResponse(2, 10)),
+  };
+  reset(hostWithPendingData(frames));
+  storeLinkState(HOST_CHANNEL, HOST_ADDRESS);
+
+  Ieee802154NetworkNode node(configuration);
+  EXPECT(node.sendMessage({0x01}));
+  SimulatedMedium::instance().waitForDeliveries();
+
+  EXPECT(SimulatedMedium::instance().delivered() == frames.size());
+  EXPECT(GCMEncryption::decrypt_calls == 1);
+  auto payload = node.pendingPayload();
+  EXPECT(payload && *payload == std::vector<uint8_t>(10, 2));
+}
+
+// The radio is kept initialized from prepare() until release(), and is otherwise turned off after each message.
+static void testPrepareAndRelease() {
+  reset(hostWithoutPendingData());
+  storeLinkState(HOST_CHANNEL, HOST_ADDRESS);
+  auto &medium = SimulatedMedium::instance();
+  OtaHelper::cancel_rollback_calls = 0;
+
+  Ieee802154NetworkNode node(configuration);
+  EXPECT(node.sendMessage({0x01}));
+  EXPECT(!medium.radioOn());
+
+  node.prepare();
+  EXPECT(OtaHelper::cancel_rollback_calls == 1);
+  EXPECT(node.sendMessage({0x01}));
+  EXPECT(medium.radioOn());
+  EXPECT(medium.channel() == HOST_CHANNEL);
+  EXPECT(node.sendMessage({0x02}));
+  EXPECT(medium.radioOn());
+  node.release();
+  EXPECT(!medium.radioOn());
+
+  // Released right away, waits for the prepare task.
+  node.prepare();
+  node.release();
+  EXPECT(!medium.radioOn());
+  EXPECT(OtaHelper::cancel_rollback_calls == 1);
+}
+
+// Destroyed right after prepare(), waits for the prepare task and turns off the radio.
+static void testDestroyAfterPrepare() {
+  reset(hostWithoutPendingData());
+  storeLinkState(HOST_CHANNEL, HOST_ADDRESS);
+  for (int i = 0; i < 20; ++i) {
+    auto node = std::make_unique<Ieee802154NetworkNode>(configuration);
+    node->prepare();
+    node.reset();
+    EXPECT(!SimulatedMedium::instance().radioOn());
+  }
+}
+
+// Two hosts answer the discovery on different channels, the one with the best RSSI is stored and used.
+static void testDiscoveryPicksBestHost() {
+  struct {
+    uint64_t address;
+    uint8_t channel;
+    int8_t rssi;
+  } hosts[] = {{OTHER_HOST_ADDRESS, 20, -80}, {HOST_ADDRESS, HOST_CHANNEL, -40}};
+  std::vector<uint64_t> transmitted_to;
+  reset({
+      .on_transmit =
+          [&](uint8_t channel, uint64_t destination_address, std::vector<uint8_t>) {
+            transmitted_to.push_back(destination_address);
+            return channel == HOST_CHANNEL && destination_address == HOST_ADDRESS;
+          },
+      .on_broadcast =
+          [&](uint8_t channel, std::vector<uint8_t> payload) {
+            auto request = host_encryption.decrypt(payload);
+            if (request.empty() || request[0] != Ieee802154NetworkShared::MESSAGE_ID_DISCOVERY_REQUEST_V1) {
+              return;
+            }
+            for (auto &host : hosts) {
+              if (host.channel == channel) {
+                SimulatedMedium::instance().send({fromHost(
+                    host.address, {Ieee802154NetworkShared::MESSAGE_ID_DISCOVERY_RESPONSE_V1, channel}, host.rssi)});
+              }
+            }
+          },
+      .on_data_request = [](uint8_t, uint64_t) { return Ieee802154::DataRequestResult::NoDataAvailable; },
+  });
+
+  Ieee802154NetworkNode node(configuration);
+  EXPECT(node.sendMessage({0x01}));
+  SimulatedMedium::instance().waitForDeliveries();
+
+  EXPECT(transmitted_to == std::vector<uint64_t>({HOST_ADDRESS}));
+  EXPECT(SimulatedMedium::instance().channel() == HOST_CHANNEL);
+  NvsStorage nvs_storage("Ieee802154");
+  uint8_t channel = 0;
+  uint64_t host_address = 0;
+  EXPECT(nvs_storage.readFromNVS("channel", channel) && channel == HOST_CHANNEL);
+  EXPECT(nvs_storage.readFromNVS("host", host_address) && host_address == HOST_ADDRESS);
+}
+
+int main() {
+  testHostBurstWithSlowConsumer();
+  testBurstLargerThanRing();
+  testForeignFramesDoNotExtendDataWait();
+  testInvalidFramesAreNotDecrypted();
+  testPrepareAndRelease();
+  testDestroyAfterPrepare();
+  testDiscoveryPicksBestHost();
+  if (failures == 0) {
+    printf("All tests passed\n");
+  }
+  return failures == 0 ? 0 : 1;
+}
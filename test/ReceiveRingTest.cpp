@@ -0,0 +1,144 @@
+#include "ReceiveRing.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+// Most frames the host sends back to back after a data request: forget host, timestamp, payload and the three
+// firmware update messages (WiFi credentials, checksum and URL).
+static constexpr size_t MAX_HOST_BURST = 6;
+static constexpr size_t ROUNDS = 10000;
+
+static int failures = 0;
+
+#define EXPECT(condition)                                                                                              \
+  if (!(condition)) {                                                                                                  \
+    printf("%s:%d: expected %s\n", __FILE__, __LINE__, #condition);                                                    \
+    ++failures;                                                                                                        \
+  }
+
+static Ieee802154::Message makeMessage(uint32_t index) {
+  Ieee802154::Message message = {
+      .source_address = 0x1234000000000000ULL | index,
+      .rssi = (int8_t)(-(int)(index % 100)),
+      .payload = {},
+  };
+  // Vary size up to a full frame, content derived from index.
+  message.payload.resize(1 + index % ReceiveRing::MAX_PAYLOAD_SIZE);
+  for (size_t i = 0; i < message.payload.size(); ++i) {
+    message.payload[i] = (uint8_t)(index + i);
+  }
+  return message;
+}
+
+static bool matches(const ReceiveRing::Frame &frame, uint32_t index) {
+  auto expected = makeMessage(index);
+  if (frame.source_address != expected.source_address || frame.rssi != expected.rssi ||
+      frame.payload_size != expected.payload.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < frame.payload_size; ++i) {
+    if (frame.payload[i] != expected.payload[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Worst case: the sending task does not get to run at all while the host sends a full burst back to back, for
+// example because it is busy decrypting a previous frame or preempted.
+static void testBurstWithStalledConsumer() {
+  ReceiveRing ring;
+  std::atomic<uint32_t> bursts_sent = 0;
+  std::atomic<uint32_t> bursts_drained = 0;
+
+  std::thread radio([&] {
+    uint32_t index = 0;
+    for (uint32_t round = 0; round < ROUNDS; ++round) {
+      while (bursts_drained.load() != round) {
+        std::this_thread::yield();
+      }
+      for (size_t i = 0; i < MAX_HOST_BURST; ++i) {
+        ring.push(makeMessage(index++));
+      }
+      bursts_sent.store(round + 1);
+    }
+  });
+
+  uint32_t index = 0;
+  for (uint32_t round = 0; round < ROUNDS; ++round) {
+    while (bursts_sent.load() != round + 1) {
+      std::this_thread::yield();
+    }
+    while (auto frame = ring.peek()) {
+      EXPECT(matches(*frame, index));
+      ++index;
+      ring.pop();
+    }
+    bursts_drained.store(round + 1);
+  }
+  radio.join();
+
+  EXPECT(ring.dropped() == 0);
+  EXPECT(index == ROUNDS * MAX_HOST_BURST);
+}
+
+// Radio and sending task running concurrently, the next burst starting as soon as the previous has been processed.
+static void testBurstWithConcurrentConsumer() {
+  ReceiveRing ring;
+  std::atomic<uint32_t> processed = 0;
+
+  std::thread radio([&] {
+    uint32_t index = 0;
+    for (uint32_t round = 0; round < ROUNDS; ++round) {
+      while (processed.load() != index) {
+        std::this_thread::yield();
+      }
+      for (size_t i = 0; i < MAX_HOST_BURST; ++i) {
+        ring.push(makeMessage(index++));
+      }
+    }
+  });
+
+  uint32_t index = 0;
+  while (index < ROUNDS * MAX_HOST_BURST) {
+    auto frame = ring.peek();
+    if (frame == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+    EXPECT(matches(*frame, index));
+    ++index;
+    ring.pop();
+    processed.store(index);
+  }
+  radio.join();
+
+  EXPECT(ring.dropped() == 0);
+}
+
+static void testOverflowIsCounted() {
+  ReceiveRing ring;
+  for (uint32_t i = 0; i < ReceiveRing::CAPACITY; ++i) {
+    EXPECT(ring.push(makeMessage(i)) == (i < ReceiveRing::CAPACITY - 1));
+  }
+  EXPECT(ring.dropped() == 1);
+
+  // Oldest frames are kept.
+  auto frame = ring.peek();
+  EXPECT(frame != nullptr && matches(*frame, 0));
+
+  ring.clear();
+  EXPECT(ring.peek() == nullptr);
+  EXPECT(ring.dropped() == 0);
+}
+
+int main() {
+  static_assert(MAX_HOST_BURST <= ReceiveRing::CAPACITY - 1, "Ring must fit a full host burst");
+  testBurstWithStalledConsumer();
+  testBurstWithConcurrentConsumer();
+  testOverflowIsCounted();
+  if (failures == 0) {
+    printf("All tests passed\n");
+  }
+  return failures == 0 ? 0 : 1;
+}
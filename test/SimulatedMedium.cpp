@@ -0,0 +1,163 @@
+#include "SimulatedMedium.h"
+
+// 250 kbit/s, 32 us per byte.
+static constexpr auto BYTE_TIME = std::chrono::microseconds(32);
+// Preamble, start of frame delimiter and PHY header.
+static constexpr size_t PHY_OVERHEAD = 6;
+// Frame control, sequence number, PAN ID and two extended addresses, plus FCS.
+static constexpr size_t MAC_OVERHEAD = 21 + 2;
+// RX to TX turnaround before the acknowledgement.
+static constexpr auto TURNAROUND_TIME = std::chrono::microseconds(192);
+// Acknowledgement frame including PHY overhead.
+static constexpr size_t ACK_SIZE = 11;
+static constexpr int MAX_RETRIES = 3;
+
+SimulatedMedium &SimulatedMedium::instance() {
+  static SimulatedMedium medium;
+  return medium;
+}
+
+void SimulatedMedium::reset(Host host) {
+  waitForDeliveries();
+  std::scoped_lock lock(_mutex);
+  _host = host;
+  _receiver = {};
+  _channel = 0;
+  _radio_on = false;
+  _delivered = 0;
+  _lost = 0;
+}
+
+std::chrono::microseconds SimulatedMedium::airTime(size_t payload_size) {
+  return (PHY_OVERHEAD + MAC_OVERHEAD + payload_size) * BYTE_TIME + TURNAROUND_TIME + ACK_SIZE * BYTE_TIME;
+}
+
+void SimulatedMedium::send(std::vector<Ieee802154::Message> frames, std::chrono::microseconds start_delay,
+                           std::chrono::microseconds gap) {
+  std::scoped_lock lock(_mutex);
+  _deliveries.emplace_back([this, frames, start_delay, gap] {
+    auto next = std::chrono::steady_clock::now() + start_delay;
+    for (auto &frame : frames) {
+      for (int attempt = 0; attempt <= MAX_RETRIES; ++attempt) {
+        next += airTime(frame.payload.size());
+        std::this_thread::sleep_until(next);
+        if (deliver(frame)) {
+          break;
+        }
+        if (attempt == MAX_RETRIES) {
+          std::scoped_lock lock(_mutex);
+          ++_lost;
+        }
+      }
+      next += gap;
+    }
+  });
+}
+
+bool SimulatedMedium::deliver(const Ieee802154::Message &frame) {
+  std::scoped_lock lock(_mutex);
+  if (!_radio_on || !_receiver) {
+    return false;
+  }
+  _receiver(frame);
+  ++_delivered;
+  return true;
+}
+
+void SimulatedMedium::waitForDeliveries() {
+  std::vector<std::thread> deliveries;
+  {
+    std::scoped_lock lock(_mutex);
+    deliveries.swap(_deliveries);
+  }
+  for (auto &delivery : deliveries) {
+    delivery.join();
+  }
+}
+
+size_t SimulatedMedium::delivered() {
+  std::scoped_lock lock(_mutex);
+  return _delivered;
+}
+
+size_t SimulatedMedium::lost() {
+  std::scoped_lock lock(_mutex);
+  return _lost;
+}
+
+void SimulatedMedium::setReceiver(Ieee802154::OnMessage on_message) {
+  std::scoped_lock lock(_mutex);
+  _receiver = on_message;
+}
+
+void SimulatedMedium::setChannel(uint8_t channel) {
+  std::scoped_lock lock(_mutex);
+  _channel = channel;
+}
+
+void SimulatedMedium::setRadioOn(bool on) {
+  std::scoped_lock lock(_mutex);
+  _radio_on = on;
+}
+
+uint8_t SimulatedMedium::channel() {
+  std::scoped_lock lock(_mutex);
+  return _channel;
+}
+
+bool SimulatedMedium::radioOn() {
+  std::scoped_lock lock(_mutex);
+  return _radio_on;
+}
+
+bool SimulatedMedium::transmit(uint64_t destination_address, const uint8_t *data, size_t data_size) {
+  std::this_thread::sleep_for(airTime(data_size));
+  auto on_transmit = _host.on_transmit;
+  return on_transmit && radioOn() &&
+         on_transmit(channel(), destination_address, std::vector<uint8_t>(data, data + data_size));
+}
+
+void SimulatedMedium::broadcast(const uint8_t *data, size_t data_size) {
+  std::this_thread::sleep_for(airTime(data_size));
+  auto on_broadcast = _host.on_broadcast;
+  if (on_broadcast && radioOn()) {
+    on_broadcast(channel(), std::vector<uint8_t>(data, data + data_size));
+  }
+}
+
+Ieee802154::DataRequestResult SimulatedMedium::dataRequest(uint64_t destination_address) {
+  std::this_thread::sleep_for(airTime(1));
+  auto on_data_request = _host.on_data_request;
+  if (!on_data_request || !radioOn()) {
+    return Ieee802154::DataRequestResult::Failure;
+  }
+  return on_data_request(channel(), destination_address);
+}
+
+// Fake Ieee802154, forwarding to the medium.
+
+void Ieee802154::initialize(bool) { SimulatedMedium::instance().setRadioOn(true); }
+
+void Ieee802154::teardown() {
+  SimulatedMedium::instance().setReceiver({});
+  SimulatedMedium::instance().setRadioOn(false);
+}
+
+void Ieee802154::setChannel(uint8_t channel) { SimulatedMedium::instance().setChannel(channel); }
+
+bool Ieee802154::transmit(uint64_t destination_address, const uint8_t *data, size_t data_size) {
+  ++_sequence_number;
+  return SimulatedMedium::instance().transmit(destination_address, data, data_size);
+}
+
+void Ieee802154::broadcast(const uint8_t *data, size_t data_size) {
+  ++_sequence_number;
+  SimulatedMedium::instance().broadcast(data, data_size);
+}
+
+Ieee802154::DataRequestResult Ieee802154::dataRequest(uint64_t destination_address) {
+  ++_sequence_number;
+  return SimulatedMedium::instance().dataRequest(destination_address);
+}
+
+void Ieee802154::receive(OnMessage on_message) { SimulatedMedium::instance().setReceiver(on_message); }
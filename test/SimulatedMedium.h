@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Ieee802154.h>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Simulated 802.15.4 medium between the node under test, through the fake Ieee802154, and a simulated host.
+ * Frames from the host are delivered to the node's receive callback from a separate thread, like the radio driver,
+ * spaced with the air time of each frame at 250 kbit/s including the acknowledgement. This is the fastest a host can
+ * send frames back to back.
+ */
+class SimulatedMedium {
+public:
+  struct Host {
+    std::function<bool(uint8_t channel, uint64_t destination_address, std::vector<uint8_t> payload)> on_transmit;
+    std::function<void(uint8_t channel, std::vector<uint8_t> payload)> on_broadcast;
+    std::function<Ieee802154::DataRequestResult(uint8_t channel, uint64_t destination_address)> on_data_request;
+  };
+
+  static SimulatedMedium &instance();
+
+  /**
+   * Wait for any ongoing deliveries, then start over with a new host.
+   */
+  void reset(Host host);
+
+  /**
+   * Send frames to the node, back to back. The first frame is sent after start_delay, and additional gap is added
+   * between frames. A frame that arrives while the node is not receiving is retransmitted, like the host MAC would do
+   * for an unacknowledged frame, and counted as lost once retries are exhausted.
+   */
+  void send(std::vector<Ieee802154::Message> frames, std::chrono::microseconds start_delay = {},
+            std::chrono::microseconds gap = {});
+
+  /**
+   * Wait for all frames passed to send() to be delivered or lost.
+   */
+  void waitForDeliveries();
+
+  size_t delivered();
+  size_t lost();
+
+  static std::chrono::microseconds airTime(size_t payload_size);
+
+public: // Called by the fake Ieee802154.
+  void setReceiver(Ieee802154::OnMessage on_message);
+  void setChannel(uint8_t channel);
+  void setRadioOn(bool on);
+  bool transmit(uint64_t destination_address, const uint8_t *data, size_t data_size);
+  void broadcast(const uint8_t *data, size_t data_size);
+  Ieee802154::DataRequestResult dataRequest(uint64_t destination_address);
+
+public:
+  uint8_t channel();
+  bool radioOn();
+
+private:
+  bool deliver(const Ieee802154::Message &frame);
+
+  std::mutex _mutex;
+  Host _host;
+  Ieee802154::OnMessage _receiver;
+  uint8_t _channel = 0;
+  bool _radio_on = false;
+  size_t _delivered = 0;
+  size_t _lost = 0;
+  std::vector<std::thread> _deliveries;
+};
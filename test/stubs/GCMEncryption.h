@@ -0,0 +1,59 @@
+#pragma once
+
+// Host side fake of GCMEncryption. Not encryption: prepends a fresh IV and a tag over IV and plaintext, so corrupted
+// or foreign frames fail to "decrypt" like with the real implementation. Same overhead as AES-GCM (12 + 16 bytes).
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class GCMEncryption {
+public:
+  static constexpr size_t IV_SIZE = 12;
+  static constexpr size_t TAG_SIZE = 16;
+
+  GCMEncryption(const char *, const char *, bool) {}
+
+  std::vector<uint8_t> encrypt(const void *message, size_t message_size) {
+    auto bytes = reinterpret_cast<const uint8_t *>(message);
+    std::vector<uint8_t> encrypted(IV_SIZE + TAG_SIZE);
+    for (size_t i = 0; i < IV_SIZE; ++i) {
+      encrypted[i] = (uint8_t)(_iv_counter >> (8 * (i % 4)));
+    }
+    ++_iv_counter;
+    encrypted.insert(encrypted.end(), bytes, bytes + message_size);
+    auto t = tag(encrypted);
+    std::copy(t.begin(), t.end(), encrypted.begin() + IV_SIZE);
+    return encrypted;
+  }
+
+  std::vector<uint8_t> decrypt(const std::vector<uint8_t> &encrypted) {
+    ++decrypt_calls;
+    std::this_thread::sleep_for(decrypt_delay);
+    if (encrypted.size() < IV_SIZE + TAG_SIZE ||
+        !std::equal(encrypted.begin() + IV_SIZE, encrypted.begin() + IV_SIZE + TAG_SIZE, tag(encrypted).begin())) {
+      return {};
+    }
+    return std::vector<uint8_t>(encrypted.begin() + IV_SIZE + TAG_SIZE, encrypted.end());
+  }
+
+  // Simulated cost of one decryption, to model a sending task slower than the radio.
+  static inline std::chrono::microseconds decrypt_delay{0};
+  static inline int decrypt_calls = 0;
+
+private:
+  static std::vector<uint8_t> tag(const std::vector<uint8_t> &encrypted) {
+    std::vector<uint8_t> result(TAG_SIZE, 0x5a);
+    for (size_t i = 0; i < encrypted.size(); ++i) {
+      if (i < IV_SIZE || i >= IV_SIZE + TAG_SIZE) {
+        result[i % TAG_SIZE] = (uint8_t)(result[i % TAG_SIZE] * 31 + encrypted[i]);
+      }
+    }
+    return result;
+  }
+
+  uint32_t _iv_counter = 0;
+};
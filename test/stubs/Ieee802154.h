@@ -0,0 +1,45 @@
+#pragma once
+
+// Host side fake of the ieee-802_15_4 component. All radio operations go to the SimulatedMedium.
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class Ieee802154 {
+public:
+  struct Message {
+    uint64_t source_address;
+    int8_t rssi;
+    std::vector<uint8_t> payload;
+  };
+
+  typedef std::function<void(Message message)> OnMessage;
+
+  struct Configuration {
+    uint8_t channel;
+    uint16_t pan_id;
+    uint8_t initial_sequence_number;
+  };
+
+  enum class DataRequestResult {
+    Failure,
+    NoDataAvailable,
+    DataAvailable,
+  };
+
+  Ieee802154(Configuration configuration) : _sequence_number(configuration.initial_sequence_number) {}
+
+  void initialize(bool initialize_nvs);
+  void teardown();
+  void setChannel(uint8_t channel);
+  uint8_t nextSequenceNumber() { return _sequence_number; }
+  bool transmit(uint64_t destination_address, const uint8_t *data, size_t data_size);
+  void broadcast(const uint8_t *data, size_t data_size);
+  DataRequestResult dataRequest(uint64_t destination_address);
+  void receive(OnMessage on_message);
+  uint64_t deviceMacAddress() { return 0x00000000000000ABULL; }
+
+private:
+  uint8_t _sequence_number;
+};
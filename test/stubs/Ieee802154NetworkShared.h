@@ -0,0 +1,62 @@
+#pragma once
+
+// Host side stand-in for the ieee-802_15_4-network-shared message definitions used by the node.
+#include <cstdint>
+
+namespace Ieee802154NetworkShared {
+
+const uint8_t MESSAGE_ID_MESSAGE = 0x01;
+const uint8_t MESSAGE_ID_DISCOVERY_REQUEST_V1 = 0x02;
+const uint8_t MESSAGE_ID_DISCOVERY_RESPONSE_V1 = 0x03;
+const uint8_t MESSAGE_ID_PENDING_TIMESTAMP_RESPONSE_V1 = 0x04;
+const uint8_t MESSAGE_ID_PENDING_PAYLOAD_RESPONSE_V1 = 0x05;
+const uint8_t MESSAGE_ID_PENDING_FIRMWARE_WIFI_CREDENTIALS_RESPONSE_V1 = 0x06;
+const uint8_t MESSAGE_ID_PENDING_FIRMWARE_CHECKSUM_RESPONSE_V1 = 0x07;
+const uint8_t MESSAGE_ID_PENDING_FIRMWARE_URL_RESPONSE_V1 = 0x08;
+const uint8_t MESSAGE_ID_FORGET_HOST_RESPONSE_V1 = 0x09;
+
+struct __attribute__((packed)) MessageV1 {
+  uint8_t id = MESSAGE_ID_MESSAGE;
+  uint32_t firmware_version;
+  uint8_t payload[];
+};
+
+struct __attribute__((packed)) DiscoveryRequestV1 {
+  uint8_t id = MESSAGE_ID_DISCOVERY_REQUEST_V1;
+};
+
+struct __attribute__((packed)) DiscoveryResponseV1 {
+  uint8_t id = MESSAGE_ID_DISCOVERY_RESPONSE_V1;
+  uint8_t channel;
+};
+
+struct __attribute__((packed)) PendingTimestampResponseV1 {
+  uint8_t id = MESSAGE_ID_PENDING_TIMESTAMP_RESPONSE_V1;
+  uint64_t timestamp;
+};
+
+struct __attribute__((packed)) PendingPayloadResponseV1 {
+  uint8_t id = MESSAGE_ID_PENDING_PAYLOAD_RESPONSE_V1;
+  uint8_t payload[];
+};
+
+struct __attribute__((packed)) PendingFirmwareWifiCredentialsResponseV1 {
+  uint8_t id = MESSAGE_ID_PENDING_FIRMWARE_WIFI_CREDENTIALS_RESPONSE_V1;
+  uint32_t identifier;
+  char wifi_ssid[32];
+  char wifi_password[32];
+};
+
+struct __attribute__((packed)) PendingFirmwareChecksumResponseV1 {
+  uint8_t id = MESSAGE_ID_PENDING_FIRMWARE_CHECKSUM_RESPONSE_V1;
+  uint32_t identifier;
+  char md5[32];
+};
+
+struct __attribute__((packed)) PendingFirmwareUrlResponseV1 {
+  uint8_t id = MESSAGE_ID_PENDING_FIRMWARE_URL_RESPONSE_V1;
+  uint32_t identifier;
+  char url[74];
+};
+
+} // namespace Ieee802154NetworkShared
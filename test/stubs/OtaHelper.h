@@ -0,0 +1,31 @@
+#pragma once
+
+// Host side stand-in for OtaHelper from ConnectionHelper.
+#include <string>
+
+namespace OtaHelperLog {
+const char TAG[] = "OtaHelper";
+};
+
+class OtaHelper {
+public:
+  enum class RollbackStrategy { AUTO, MANUAL };
+  enum class FlashMode { FIRMWARE };
+
+  struct Configuration {
+    struct {
+      bool enabled;
+    } web_ota;
+    struct {
+      bool enabled;
+    } arduino_ota;
+    RollbackStrategy rollback_strategy;
+  };
+
+  OtaHelper(Configuration) {}
+
+  void cancelRollback() { ++cancel_rollback_calls; }
+  bool updateFrom(std::string, FlashMode, std::string) { return false; }
+
+  static inline int cancel_rollback_calls = 0;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+// Host side stand-in for WiFiHelper from ConnectionHelper.
+#include <cstdint>
+
+namespace WiFiHelperLog {
+const char TAG[] = "WiFiHelper";
+};
+
+class WiFiHelper {
+public:
+  WiFiHelper(const char *) {}
+  bool connectToAp(const char *, const char *, bool, uint32_t) { return false; }
+  void disconnect() {}
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+// Host side stand-ins for ESP-IDF definitions the node gets transitively from ESP-IDF headers.
+#include <cstdint>
+#include <cstdlib>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NVS_NOT_FOUND 0x1102
+#define ESP_ERR_NVS_NO_FREE_PAGES 0x110d
+#define ESP_ERR_NVS_NEW_VERSION_FOUND 0x1110
+#define ESP_ERROR_CHECK(x)                                                                                             \
+  if ((x) != ESP_OK) {                                                                                                 \
+    abort();                                                                                                           \
+  }
+
+#define RTC_NOINIT_ATTR
+
+inline const char *esp_err_to_name(esp_err_t) { return "error"; }
+inline uint32_t esp_random() { return (uint32_t)rand(); }
+inline void esp_restart() { abort(); }
@@ -0,0 +1,31 @@
+#pragma once
+
+// Host side stand-in for ESP-IDF logging.
+#include "esp_idf.h"
+#include <cstdarg>
+#include <cstdio>
+
+typedef enum {
+  ESP_LOG_NONE,
+  ESP_LOG_ERROR,
+  ESP_LOG_WARN,
+  ESP_LOG_INFO,
+  ESP_LOG_DEBUG,
+} esp_log_level_t;
+
+inline void esp_log_level_set(const char *, esp_log_level_t) {}
+
+// Not declared as printf like, as ESP-IDF types (uint64_t, size_t) differ from the host.
+inline void esp_log_write_stub(char level, const char *tag, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  printf("%c (%s) ", level, tag);
+  vprintf(format, args);
+  printf("\n");
+  va_end(args);
+}
+
+#define ESP_LOGE(tag, format, ...) esp_log_write_stub('E', tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) esp_log_write_stub('W', tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) esp_log_write_stub('I', tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) esp_log_write_stub('D', tag, format, ##__VA_ARGS__)
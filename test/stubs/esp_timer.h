@@ -0,0 +1,11 @@
+#pragma once
+
+// Minimal host side stand-in for ESP-IDF esp_timer.
+#include <chrono>
+#include <cstdint>
+
+inline int64_t esp_timer_get_time() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
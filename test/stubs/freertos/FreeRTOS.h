@@ -0,0 +1,38 @@
+#pragma once
+
+// Host side stand-in for FreeRTOS, on top of the C++ standard library. One tick is one millisecond.
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+typedef uint32_t TickType_t;
+typedef uint32_t EventBits_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS 1
+#define pdFAIL 0
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY 0xffffffffUL
+#define BIT0 0x00000001
+
+inline TickType_t freertos_stub_ticks() {
+  static auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Wait on condition variable for the given number of ticks, or forever.
+template <typename Predicate>
+bool freertos_stub_wait(std::condition_variable &cv, std::unique_lock<std::mutex> &lock, TickType_t ticks,
+                        Predicate predicate) {
+  if (ticks == portMAX_DELAY) {
+    cv.wait(lock, predicate);
+    return true;
+  }
+  return cv.wait_for(lock, std::chrono::milliseconds(ticks), predicate);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+// Host side stand-in for FreeRTOS event groups.
+#include "FreeRTOS.h"
+
+struct EventGroupStub {
+  std::mutex mutex;
+  std::condition_variable cv;
+  EventBits_t bits = 0;
+};
+typedef EventGroupStub *EventGroupHandle_t;
+
+inline EventGroupHandle_t xEventGroupCreate() { return new EventGroupStub(); }
+inline void vEventGroupDelete(EventGroupHandle_t event_group) { delete event_group; }
+
+inline EventBits_t xEventGroupSetBits(EventGroupHandle_t event_group, EventBits_t bits) {
+  std::scoped_lock lock(event_group->mutex);
+  event_group->bits |= bits;
+  event_group->cv.notify_all();
+  return event_group->bits;
+}
+
+inline EventBits_t xEventGroupClearBits(EventGroupHandle_t event_group, EventBits_t bits) {
+  std::scoped_lock lock(event_group->mutex);
+  auto result = event_group->bits;
+  event_group->bits &= ~bits;
+  return result;
+}
+
+inline EventBits_t xEventGroupWaitBits(EventGroupHandle_t event_group, EventBits_t bits, BaseType_t clear_on_exit,
+                                       BaseType_t wait_for_all, TickType_t ticks) {
+  std::unique_lock lock(event_group->mutex);
+  auto satisfied = [&] {
+    return wait_for_all ? (event_group->bits & bits) == bits : (event_group->bits & bits) != 0;
+  };
+  bool ok = freertos_stub_wait(event_group->cv, lock, ticks, satisfied);
+  auto result = event_group->bits;
+  if (ok && clear_on_exit) {
+    event_group->bits &= ~bits;
+  }
+  return result;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+// Host side stand-in for FreeRTOS tasks, using detached threads.
+#include "FreeRTOS.h"
+#include <thread>
+
+inline TickType_t xTaskGetTickCount() { return freertos_stub_ticks(); }
+
+inline void vTaskDelay(TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
+
+inline UBaseType_t uxTaskPriorityGet(TaskHandle_t) { return 1; }
+
+inline BaseType_t xTaskCreate(TaskFunction_t function, const char *, uint32_t, void *parameters, UBaseType_t,
+                              TaskHandle_t *) {
+  std::thread(function, parameters).detach();
+  return pdPASS;
+}
+
+// Only supported as the last statement of a task function, where the thread then returns.
+inline void vTaskDelete(TaskHandle_t) {}
@@ -0,0 +1,47 @@
+#pragma once
+
+// Host side stand-in for ESP-IDF NVS, backed by an in memory map.
+#include "esp_idf.h"
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef uint32_t nvs_handle_t;
+typedef enum {
+  NVS_READONLY,
+  NVS_READWRITE,
+} nvs_open_mode_t;
+
+inline std::map<std::string, std::vector<uint8_t>> nvs_stub_storage;
+inline std::vector<std::string> nvs_stub_handles;
+
+inline esp_err_t nvs_open(const char *namespace_name, nvs_open_mode_t, nvs_handle_t *handle) {
+  nvs_stub_handles.push_back(namespace_name);
+  *handle = nvs_stub_handles.size() - 1;
+  return ESP_OK;
+}
+inline void nvs_close(nvs_handle_t) {}
+inline esp_err_t nvs_commit(nvs_handle_t) { return ESP_OK; }
+
+inline esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *value, size_t *length) {
+  auto it = nvs_stub_storage.find(nvs_stub_handles[handle] + "/" + key);
+  if (it == nvs_stub_storage.end() || it->second.size() > *length) {
+    return ESP_ERR_NVS_NOT_FOUND;
+  }
+  memcpy(value, it->second.data(), it->second.size());
+  *length = it->second.size();
+  return ESP_OK;
+}
+
+inline esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length) {
+  auto bytes = reinterpret_cast<const uint8_t *>(value);
+  nvs_stub_storage[nvs_stub_handles[handle] + "/" + key] = std::vector<uint8_t>(bytes, bytes + length);
+  return ESP_OK;
+}
+
+inline esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key) {
+  nvs_stub_storage.erase(nvs_stub_handles[handle] + "/" + key);
+  return ESP_OK;
+}
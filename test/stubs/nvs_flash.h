@@ -0,0 +1,10 @@
+#pragma once
+
+// Host side stand-in for ESP-IDF NVS flash.
+#include "nvs.h"
+
+inline esp_err_t nvs_flash_init() { return ESP_OK; }
+inline esp_err_t nvs_flash_erase() {
+  nvs_stub_storage.clear();
+  return ESP_OK;
+}